@@ -0,0 +1,350 @@
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <thread>
+#include <vector>
+
+#include "estruturas.h"
+#include "gerador.h"
+
+// -----------------------------------------------------------
+// Busca em profundidade sobre as operações 1..5 do nível Mestre.
+//
+// As próximas peças são conhecidas (cópia do gerador do jogo), então
+// o jogo é determinístico e a busca maximiza a soma dos pontos das
+// peças jogadas ao longo de "profundidade" operações. Os movimentos
+// são feitos e desfeitos no próprio estado, sem cloná-lo, e os
+// valores já calculados ficam numa tabela de transposição indexada
+// por um hash do conteúdo compactado (2 bits por peça) da fila e da
+// pilha.
+// -----------------------------------------------------------
+
+#define BUSCA_MAX_PROFUNDIDADE 32
+#define BUSCA_TAM_TABELA (1 << 16)  // entradas da tabela (potência de dois)
+
+// -----------------------------------------------------------
+// Critério de pontuação. Para que a tabela de transposição seja
+// válida, os pontos devem depender apenas dos tipos das peças.
+// -----------------------------------------------------------
+template <int N, int M>
+struct Criterio {
+    // pontos por peça jogada (opção 1) ou usada da reserva (opção 3)
+    int (*pontuarPeca)(Peca jogada);
+    // pontos extras do estado ao fim da sequência (pode ser NULL)
+    int (*avaliarFolha)(const FilaCircular<Peca, N> *f, const PilhaLimitada<Peca, M> *p);
+};
+
+// Critério padrão: maximizar peças I jogadas
+static inline int pontuarPecaI(Peca jogada) {
+    return jogada.nome == 'I';
+}
+
+typedef struct {
+    uint64_t chave;   // hash do estado, 0 = entrada vazia
+    int valor;        // melhor soma de pontos a partir do estado
+} EntradaTabela;
+
+template <int N, int M>
+struct EstadoBusca {
+    FilaCircular<Peca, N> fila;
+    PilhaLimitada<Peca, M> pilha;
+    char proximas[BUSCA_MAX_PROFUNDIDADE];  // tipos das próximas peças
+    int consumidas;       // peças de proximas já geradas neste caminho
+    int contadorId;       // id da primeira peça de proximas
+    int k;                // peças da troca múltipla (opção 5)
+    const Criterio<N, M> *criterio;
+    EntradaTabela *tabela;
+    long long nos;        // nós visitados
+};
+
+// Informação para desfazer uma operação
+typedef struct {
+    Peca peca;   // peça removida da frente (1, 2) ou da pilha (3)
+    int pontos;  // pontos ganhos com a operação
+} Desfazer;
+
+// -----------------------------------------------------------
+// Hash do estado: tipos da fila e da pilha compactados em 2 bits,
+// ocupação, peças consumidas e profundidade restante
+// -----------------------------------------------------------
+static inline uint64_t misturar(uint64_t h, uint64_t v) {
+    // finalizador do splitmix64 sobre h ^ v
+    h ^= v;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+template <int N, int M>
+uint64_t hashEstado(const EstadoBusca<N, M> *e, int profundidade) {
+    uint64_t h = misturar(0, (uint64_t)e->fila.quantidade | (uint64_t)e->pilha.topo << 16 |
+                             (uint64_t)profundidade << 32 | (uint64_t)e->consumidas << 48);
+    uint64_t bloco = 0;
+    int usados = 0;
+    for (int i = 0; i < e->fila.quantidade + e->pilha.topo; i++) {
+        char nome = i < e->fila.quantidade
+                        ? e->fila.elementos[idxFila(&e->fila, i)].nome
+                        : e->pilha.elementos[i - e->fila.quantidade].nome;
+        bloco |= (uint64_t)indiceTipo(nome) << usados;
+        usados += 2;
+        if (usados == 64) {
+            h = misturar(h, bloco);
+            bloco = 0;
+            usados = 0;
+        }
+    }
+    h = misturar(h, bloco);
+    return h ? h : 1;
+}
+
+// -----------------------------------------------------------
+// Inverte os k primeiros da fila e o bloco de k do topo da pilha
+// -----------------------------------------------------------
+template <int N, int M>
+void inverterBlocos(FilaCircular<Peca, N> *f, PilhaLimitada<Peca, M> *p, int k) {
+    for (int i = 0, j = k - 1; i < j; i++, j--) {
+        Peca *a = &f->elementos[idxFila(f, i)];
+        Peca *b = &f->elementos[idxFila(f, j)];
+        Peca t = *a;
+        *a = *b;
+        *b = t;
+        t = p->elementos[p->topo - k + i];
+        p->elementos[p->topo - k + i] = p->elementos[p->topo - k + j];
+        p->elementos[p->topo - k + j] = t;
+    }
+}
+
+// -----------------------------------------------------------
+// Remove a peça recém-enfileirada e devolve "frente" ao início
+// (desfaz desenfileirar + enfileirar)
+// -----------------------------------------------------------
+template <int N, int M>
+void desfazerReposicao(EstadoBusca<N, M> *e, Peca frente) {
+    FilaCircular<Peca, N> *f = &e->fila;
+    f->fim = indiceCircular<N>(f->fim + N - 1);
+    f->inicio = indiceCircular<N>(f->inicio + N - 1);
+    f->elementos[f->inicio] = frente;
+    e->consumidas--;
+}
+
+// -----------------------------------------------------------
+// Retira a frente e coloca no fim sem passar por desenfileirar /
+// enfileirar: os movimentos simulados não devem aparecer nos
+// contadores de instrumentacao.h, que medem só o jogo de verdade
+// (e não são seguros entre as threads da busca paralela).
+// O chamador garante que a fila não está vazia / cheia.
+// -----------------------------------------------------------
+template <int N>
+Peca retirarFrente(FilaCircular<Peca, N> *f) {
+    Peca p = f->elementos[f->inicio];
+    f->inicio = indiceCircular<N>(f->inicio + 1);
+    f->quantidade--;
+    return p;
+}
+
+template <int N>
+void colocarNoFim(FilaCircular<Peca, N> *f, Peca p) {
+    f->elementos[f->fim] = p;
+    f->fim = indiceCircular<N>(f->fim + 1);
+    f->quantidade++;
+}
+
+// Próxima peça da sequência conhecida
+template <int N, int M>
+Peca proximaPeca(EstadoBusca<N, M> *e) {
+    Peca p;
+    p.nome = e->proximas[e->consumidas];
+    p.id = e->contadorId + e->consumidas;
+    e->consumidas++;
+    return p;
+}
+
+// -----------------------------------------------------------
+// Faz a operação op no estado; retorna 0 se ela for rejeitada
+// pelas regras (nada é alterado) e 1 se aplicada.
+// -----------------------------------------------------------
+template <int N, int M>
+int fazerOperacao(EstadoBusca<N, M> *e, int op, Desfazer *u) {
+    FilaCircular<Peca, N> *f = &e->fila;
+    PilhaLimitada<Peca, M> *p = &e->pilha;
+    u->pontos = 0;
+    switch (op) {
+        case 1:
+            if (filaVazia(f)) return 0;
+            u->peca = retirarFrente(f);
+            colocarNoFim(f, proximaPeca(e));
+            u->pontos = e->criterio->pontuarPeca(u->peca);
+            return 1;
+        case 2:
+            if (pilhaCheia(p) || filaVazia(f)) return 0;
+            u->peca = retirarFrente(f);
+            p->elementos[p->topo++] = u->peca;
+            colocarNoFim(f, proximaPeca(e));
+            return 1;
+        case 3:
+            if (pilhaVazia(p)) return 0;
+            u->peca = p->elementos[--p->topo];
+            u->pontos = e->criterio->pontuarPeca(u->peca);
+            return 1;
+        case 4: {
+            if (filaVazia(f) || pilhaVazia(p)) return 0;
+            Peca *frente = &f->elementos[f->inicio];
+            Peca t = *frente;
+            *frente = p->elementos[p->topo - 1];
+            p->elementos[p->topo - 1] = t;
+            return 1;
+        }
+        default:
+            return trocarFrenteComPilha(f, p, e->k);
+    }
+}
+
+// Desfaz a operação op (que deve ter sido aplicada por fazerOperacao)
+template <int N, int M>
+void desfazerOperacao(EstadoBusca<N, M> *e, int op, const Desfazer *u) {
+    FilaCircular<Peca, N> *f = &e->fila;
+    PilhaLimitada<Peca, M> *p = &e->pilha;
+    switch (op) {
+        case 1:
+            desfazerReposicao(e, u->peca);
+            break;
+        case 2:
+            p->topo--;
+            desfazerReposicao(e, u->peca);
+            break;
+        case 3:
+            p->elementos[p->topo++] = u->peca;
+            break;
+        case 4: {
+            Peca *frente = &f->elementos[f->inicio];
+            Peca t = *frente;
+            *frente = p->elementos[p->topo - 1];
+            p->elementos[p->topo - 1] = t;
+            break;
+        }
+        default:
+            // aplicar a troca de novo inverte os dois blocos
+            trocarFrenteComPilha(f, p, e->k);
+            inverterBlocos(f, p, e->k);
+            break;
+    }
+}
+
+// -----------------------------------------------------------
+// Melhor soma de pontos alcançável com "profundidade" operações
+// -----------------------------------------------------------
+template <int N, int M>
+int buscar(EstadoBusca<N, M> *e, int profundidade) {
+    e->nos++;
+    if (profundidade == 0) {
+        if (e->criterio->avaliarFolha == NULL) return 0;
+        return e->criterio->avaliarFolha(&e->fila, &e->pilha);
+    }
+
+    uint64_t chave = hashEstado(e, profundidade);
+    EntradaTabela *entrada = &e->tabela[chave & (BUSCA_TAM_TABELA - 1)];
+    if (entrada->chave == chave) return entrada->valor;
+
+    int melhor = 0;
+    int algumaValida = 0;
+    for (int op = 1; op <= 5; op++) {
+        Desfazer u;
+        if (!fazerOperacao(e, op, &u)) continue;
+        int v = u.pontos + buscar(e, profundidade - 1);
+        desfazerOperacao(e, op, &u);
+        if (!algumaValida || v > melhor) melhor = v;
+        algumaValida = 1;
+    }
+    if (!algumaValida) melhor = buscar(e, 0);
+
+    entrada->chave = chave;
+    entrada->valor = melhor;
+    return melhor;
+}
+
+// Prepara um estado de busca a partir do jogo (o gerador não é alterado)
+template <int N, int M>
+void prepararBusca(EstadoBusca<N, M> *e, const FilaCircular<Peca, N> *f,
+                   const PilhaLimitada<Peca, M> *p, const Gerador *g, int contadorId,
+                   int profundidade, int k, const Criterio<N, M> *criterio,
+                   EntradaTabela *tabela) {
+    Gerador copia = *g;
+    e->fila = *f;
+    e->pilha = *p;
+    preencherTipos(&copia, e->proximas, profundidade);
+    e->consumidas = 0;
+    e->contadorId = contadorId;
+    e->k = k;
+    e->criterio = criterio;
+    e->tabela = tabela;
+    e->nos = 0;
+}
+
+// -----------------------------------------------------------
+// Escolhe a melhor operação (1..5) para o jogo, olhando
+// "profundidade" operações à frente. Com paralelo != 0 cada
+// operação da raiz é buscada numa thread com tabela própria.
+// Retorna a operação (0 se nenhuma for válida ou profundidade
+// fora de 1..BUSCA_MAX_PROFUNDIDADE); em *valor a pontuação
+// esperada e em *nos os nós visitados (se não forem NULL).
+// -----------------------------------------------------------
+template <int N, int M>
+int melhorOperacao(const FilaCircular<Peca, N> *f, const PilhaLimitada<Peca, M> *p,
+                   const Gerador *g, int contadorId, int profundidade, int k,
+                   const Criterio<N, M> *criterio, int paralelo,
+                   int *valor, long long *nos) {
+    if (profundidade < 1 || profundidade > BUSCA_MAX_PROFUNDIDADE) return 0;
+
+    int numTabelas = paralelo ? 5 : 1;
+    EntradaTabela *tabelas = (EntradaTabela *)calloc((size_t)numTabelas * BUSCA_TAM_TABELA,
+                                                     sizeof(EntradaTabela));
+    if (tabelas == NULL) return 0;
+
+    int valores[6];
+    int validas[6] = {0};
+    long long totalNos = 0;
+
+    if (paralelo) {
+        std::vector<std::thread> threads;
+        std::vector<EstadoBusca<N, M>> estados(6);
+        for (int op = 1; op <= 5; op++) {
+            EstadoBusca<N, M> *e = &estados[op];
+            prepararBusca(e, f, p, g, contadorId, profundidade, k, criterio,
+                          tabelas + (size_t)(op - 1) * BUSCA_TAM_TABELA);
+            Desfazer u;
+            if (!fazerOperacao(e, op, &u)) continue;
+            validas[op] = 1;
+            threads.emplace_back([e, op, u, profundidade, &valores] {
+                valores[op] = u.pontos + buscar(e, profundidade - 1);
+            });
+        }
+        for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+        for (int op = 1; op <= 5; op++) totalNos += estados[op].nos;
+    } else {
+        EstadoBusca<N, M> e;
+        prepararBusca(&e, f, p, g, contadorId, profundidade, k, criterio, tabelas);
+        for (int op = 1; op <= 5; op++) {
+            Desfazer u;
+            if (!fazerOperacao(&e, op, &u)) continue;
+            validas[op] = 1;
+            valores[op] = u.pontos + buscar(&e, profundidade - 1);
+            desfazerOperacao(&e, op, &u);
+        }
+        totalNos = e.nos;
+    }
+    free(tabelas);
+
+    int melhor = 0;
+    for (int op = 1; op <= 5; op++) {
+        if (validas[op] && (melhor == 0 || valores[op] > valores[melhor])) melhor = op;
+    }
+    if (valor != NULL) *valor = melhor ? valores[melhor] : 0;
+    if (nos != NULL) *nos = totalNos;
+    return melhor;
+}
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef ESTRUTURAS_H
+#define ESTRUTURAS_H
+
+#include <string.h>
+
+#include "instrumentacao.h"
+
+// -----------------------------------------------------------
+// Estruturas compartilhadas pelos níveis do Tetris Stack:
+// a peça, a fila circular e a pilha de reserva.
+//
+// A capacidade é parâmetro do template, então cada programa escolhe
+// a sua (typedef FilaCircular<Peca, TAM_FILA> Fila) e experimentos
+// podem usar filas de 64 ou 1024 peças sem mudar o código.
+// -----------------------------------------------------------
+
+// -----------------------------------------------------------
+// Estrutura que representa cada peça do Tetris Stack
+// -----------------------------------------------------------
+typedef struct {
+    char nome;   // tipo da peça ('I', 'O', 'T', 'L')
+    int id;      // identificador único
+} Peca;
+
+// -----------------------------------------------------------
+// Reduz um índice em [0, 2N) ao intervalo [0, N) sem divisão:
+// máscara quando N é potência de dois, senão uma subtração
+// condicional (caso das capacidades 5 e 3 do jogo).
+// -----------------------------------------------------------
+template <int N>
+constexpr int indiceCircular(int i) {
+    static_assert(N > 0, "capacidade deve ser positiva");
+    if constexpr ((N & (N - 1)) == 0) {
+        return i & (N - 1);
+    } else {
+        return i >= N ? i - N : i;
+    }
+}
+
+// -----------------------------------------------------------
+// Fila circular com capacidade N
+// -----------------------------------------------------------
+template <typename T, int N>
+struct FilaCircular {
+    T elementos[N];
+    int inicio;      // índice do elemento da frente
+    int fim;         // índice onde será inserido o próximo elemento
+    int quantidade;  // número atual de elementos
+
+    static constexpr int capacidade = N;
+};
+
+// -----------------------------------------------------------
+// Pilha limitada (vetor) com capacidade N
+// -----------------------------------------------------------
+template <typename T, int N>
+struct PilhaLimitada {
+    T elementos[N];
+    int topo; // número de elementos; topo efetivo está em topo - 1
+
+    static constexpr int capacidade = N;
+};
+
+// -----------------------------------------------------------
+// Operações da fila
+// -----------------------------------------------------------
+template <typename T, int N>
+void esvaziarFila(FilaCircular<T, N> *f) {
+    f->inicio = 0;
+    f->fim = 0;
+    f->quantidade = 0;
+}
+
+template <typename T, int N>
+int filaCheia(const FilaCircular<T, N> *f) {
+    return f->quantidade == N;
+}
+
+template <typename T, int N>
+int filaVazia(const FilaCircular<T, N> *f) {
+    return f->quantidade == 0;
+}
+
+// Índice real na fila dado o deslocamento pos (0..quantidade-1)
+template <typename T, int N>
+int idxFila(const FilaCircular<T, N> *f, int pos) {
+    return indiceCircular<N>(f->inicio + pos);
+}
+
+// Enfileira no fim; retorna 1 em sucesso, 0 se cheia
+template <typename T, int N>
+int enfileirar(FilaCircular<T, N> *f, const T &x) {
+    INSTR_MEDIR(INSTR_ENFILEIRAR);
+    if (filaCheia(f)) {
+        INSTR_REJEITADA();
+        return 0;
+    }
+    f->elementos[f->fim] = x;
+    f->fim = indiceCircular<N>(f->fim + 1);
+    f->quantidade++;
+    return 1;
+}
+
+// Desenfileira a frente em out; retorna 1 em sucesso, 0 se vazia
+template <typename T, int N>
+int desenfileirar(FilaCircular<T, N> *f, T *out) {
+    INSTR_MEDIR(INSTR_DESENFILEIRAR);
+    if (filaVazia(f)) {
+        INSTR_REJEITADA();
+        return 0;
+    }
+    *out = f->elementos[f->inicio];
+    f->inicio = indiceCircular<N>(f->inicio + 1);
+    f->quantidade--;
+    return 1;
+}
+
+// Enfileira sempre: se cheia, descarta o elemento mais antigo.
+// Retorna 1 se descartou, 0 caso contrário.
+template <typename T, int N>
+int enfileirar_com_sobrescrita(FilaCircular<T, N> *f, const T &x) {
+    int descartou = 0;
+    if (filaCheia(f)) {
+        f->inicio = indiceCircular<N>(f->inicio + 1);
+        f->quantidade--;
+        descartou = 1;
+    }
+    enfileirar(f, x);
+    return descartou;
+}
+
+// -----------------------------------------------------------
+// Operações da pilha
+// -----------------------------------------------------------
+template <typename T, int N>
+void esvaziarPilha(PilhaLimitada<T, N> *p) {
+    p->topo = 0;
+}
+
+template <typename T, int N>
+int pilhaCheia(const PilhaLimitada<T, N> *p) {
+    return p->topo == N;
+}
+
+template <typename T, int N>
+int pilhaVazia(const PilhaLimitada<T, N> *p) {
+    return p->topo == 0;
+}
+
+// Push; retorna 1 se sucesso, 0 se cheia
+template <typename T, int N>
+int push(PilhaLimitada<T, N> *p, const T &x) {
+    INSTR_MEDIR(INSTR_PUSH);
+    if (pilhaCheia(p)) {
+        INSTR_REJEITADA();
+        return 0;
+    }
+    p->elementos[p->topo++] = x;
+    return 1;
+}
+
+// Pop em out; retorna 1 se sucesso, 0 se vazia
+template <typename T, int N>
+int pop(PilhaLimitada<T, N> *p, T *out) {
+    INSTR_MEDIR(INSTR_POP);
+    if (pilhaVazia(p)) {
+        INSTR_REJEITADA();
+        return 0;
+    }
+    *out = p->elementos[--p->topo];
+    return 1;
+}
+
+// -----------------------------------------------------------
+// Troca n elementos entre dois trechos contíguos (tmp como apoio)
+// -----------------------------------------------------------
+template <typename T>
+void trocarTrechos(T *a, T *b, T *tmp, int n) {
+    size_t bytes = sizeof(T) * n;
+    memcpy(tmp, a, bytes);
+    memcpy(a, b, bytes);
+    memcpy(b, tmp, bytes);
+}
+
+// -----------------------------------------------------------
+// Troca os k primeiros da fila com as k peças do topo da pilha:
+//   fila[i] <- i-ésima peça a partir do topo (topo vai para a frente)
+//   pilha, da base do bloco ao topo <- fila[0], ..., fila[k-1]
+// Para k = 3 com a pilha cheia é a troca múltipla do nível Mestre.
+//
+// Até TROCA_DIRETA_MAX peças a troca é feita elemento a elemento;
+// acima disso, em blocos contíguos com memcpy.
+// -----------------------------------------------------------
+#define TROCA_DIRETA_MAX 16
+
+// Elemento a elemento, sem vetor de apoio: cada par (i, k-1-i) é um
+// ciclo de quatro posições (fila[i], bloco[k-1-i], fila[k-1-i], bloco[i])
+template <typename T, int N, int M>
+void trocarEmCiclos(FilaCircular<T, N> *f, PilhaLimitada<T, M> *p, int k) {
+    T *bloco = p->elementos + p->topo - k;
+    for (int i = 0, j = k - 1; i <= j; i++, j--) {
+        T *fi = &f->elementos[idxFila(f, i)];
+        if (i == j) {
+            T t = *fi;
+            *fi = bloco[i];
+            bloco[i] = t;
+            break;
+        }
+        T *fj = &f->elementos[idxFila(f, j)];
+        T t = *fi;
+        *fi = bloco[j];
+        bloco[j] = *fj;
+        *fj = bloco[i];
+        bloco[i] = t;
+    }
+}
+
+// Em blocos: o bloco (as k peças do topo, da base para o topo) é
+// invertido no lugar e então trocado com os k primeiros de uma fila
+// circular de N posições, guardada em fila[] com a frente em inicio,
+// em no máximo dois trechos contíguos (a fila pode dar a volta)
+template <int N, typename T>
+void trocarEmBlocos(T *fila, int inicio, T *bloco, int k) {
+    for (int i = 0, j = k - 1; i < j; i++, j--) {
+        T t = bloco[i];
+        bloco[i] = bloco[j];
+        bloco[j] = t;
+    }
+
+    T tmp[N];
+    int primeiro = N - inicio; // elementos até o fim do vetor
+    if (primeiro > k) primeiro = k;
+    trocarTrechos(fila + inicio, bloco, tmp, primeiro);
+    trocarTrechos(fila, bloco + primeiro, tmp, k - primeiro);
+}
+
+// k conhecido só na execução (ex.: a busca da dica).
+// Retorna 1 se trocou, 0 se fila ou pilha têm menos de k elementos.
+template <typename T, int N, int M>
+int trocarFrenteComPilha(FilaCircular<T, N> *f, PilhaLimitada<T, M> *p, int k) {
+    if (k < 0 || f->quantidade < k || p->topo < k) return 0;
+    if (k <= TROCA_DIRETA_MAX) {
+        trocarEmCiclos(f, p, k);
+    } else {
+        trocarEmBlocos<N>(f->elementos, f->inicio, p->elementos + p->topo - k, k);
+    }
+    return 1;
+}
+
+// K fixo na compilação, sobre os vetores (fila circular de N posições
+// com a frente em inicio; bloco = as K peças do topo da pilha). Usada
+// também pelo simulador, que guarda as filas em estrutura de vetores.
+// Para K pequeno lê as 2K peças e só depois escreve, como a antiga troca
+// de três variáveis; os laços são desenrolados pelo compilador.
+template <int K, int N, typename T>
+inline void trocarFrenteComBloco(T *fila, int inicio, T *bloco) {
+    static_assert(K >= 0 && K <= N, "número de peças deve estar entre 0 e N");
+    if constexpr (K == 0) {
+        return;
+    } else if constexpr (K <= TROCA_DIRETA_MAX) {
+        T *posicao[K];
+        T frente[K], topo[K];
+#pragma GCC unroll 16
+        for (int i = 0; i < K; i++) {
+            posicao[i] = fila + indiceCircular<N>(inicio + i);
+            frente[i] = *posicao[i];
+            topo[i] = bloco[K - 1 - i];
+        }
+#pragma GCC unroll 16
+        for (int i = 0; i < K; i++) {
+            *posicao[i] = topo[i];
+            bloco[i] = frente[i];
+        }
+    } else {
+        trocarEmBlocos<N>(fila, inicio, bloco, K);
+    }
+}
+
+// trocarFrenteComPilha<TAM_TROCA_MULTIPLA>(f, p): mesma troca com K fixo
+template <int K, typename T, int N, int M>
+int trocarFrenteComPilha(FilaCircular<T, N> *f, PilhaLimitada<T, M> *p) {
+    if (f->quantidade < K || p->topo < K) return 0;
+    trocarFrenteComBloco<K, N>(f->elementos, f->inicio, p->elementos + p->topo - K);
+    return 1;
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <type_traits>
+
+// -----------------------------------------------------------
+// Fila circular para um produtor e um consumidor (SPSC) em threads
+// diferentes, sem travas. Mesma interface e semântica de FilaCircular
+// (estruturas.h): enfileirar/desenfileirar retornam 0 quando a fila
+// está cheia/vazia e enfileirar_com_sobrescrita descarta o mais antigo.
+//
+// inicio e fim são contadores de 64 bits que só crescem (não dão a
+// volta na prática) e ficam em linhas de cache separadas; cada lado
+// guarda uma cópia local do contador do outro para só ler a linha
+// compartilhada quando a cópia indica fila cheia/vazia.
+//
+// Regras de uso: enfileirar e enfileirar_com_sobrescrita só na thread
+// produtora; desenfileirar só na consumidora. filaCheia, filaVazia e
+// quantidadeFila são apenas uma fotografia do momento.
+//
+// Com sobrescrita o produtor pode regravar a posição que o consumidor
+// está lendo, por isso cada posição é um std::atomic<T> lido e escrito
+// com memory_order_relaxed. T fica restrito a tipos trivialmente
+// copiáveis cujo atomic não usa trava (na prática até 8 bytes, como
+// Peca); nesses casos os acessos compilam para movs comuns.
+// -----------------------------------------------------------
+
+#define TAM_LINHA_CACHE 64
+
+template <typename T, int N>
+struct FilaSPSC {
+    static_assert(std::is_trivially_copyable<T>::value && std::atomic<T>::is_always_lock_free,
+                  "FilaSPSC exige T trivialmente copiável com atomic sem trava");
+
+    alignas(TAM_LINHA_CACHE) std::atomic<uint64_t> inicio;  // próximo a sair (consumidor)
+    uint64_t fimVisto;      // cópia do fim vista pelo consumidor
+    alignas(TAM_LINHA_CACHE) std::atomic<uint64_t> fim;     // próximo a entrar (produtor)
+    uint64_t inicioVisto;   // cópia do início vista pelo produtor
+    alignas(TAM_LINHA_CACHE) std::atomic<T> elementos[N];
+
+    static constexpr int capacidade = N;
+};
+
+// Posição no vetor de um contador (máscara se N for potência de dois)
+template <int N>
+constexpr int posicaoSPSC(uint64_t contador) {
+    static_assert(N > 0, "capacidade deve ser positiva");
+    if constexpr ((N & (N - 1)) == 0) {
+        return (int)(contador & (N - 1));
+    } else {
+        return (int)(contador % N);
+    }
+}
+
+// Deve ser chamada antes de as threads começarem a usar a fila
+template <typename T, int N>
+void esvaziarFila(FilaSPSC<T, N> *f) {
+    f->inicio.store(0, std::memory_order_relaxed);
+    f->fim.store(0, std::memory_order_relaxed);
+    f->fimVisto = 0;
+    f->inicioVisto = 0;
+}
+
+template <typename T, int N>
+int quantidadeFila(const FilaSPSC<T, N> *f) {
+    uint64_t ini = f->inicio.load(std::memory_order_acquire);
+    uint64_t fim = f->fim.load(std::memory_order_acquire);
+    return fim > ini ? (int)(fim - ini) : 0;
+}
+
+template <typename T, int N>
+int filaCheia(const FilaSPSC<T, N> *f) {
+    return quantidadeFila(f) == N;
+}
+
+template <typename T, int N>
+int filaVazia(const FilaSPSC<T, N> *f) {
+    return quantidadeFila(f) == 0;
+}
+
+// Produtor: enfileira no fim; retorna 1 em sucesso, 0 se cheia
+template <typename T, int N>
+int enfileirar(FilaSPSC<T, N> *f, const T &x) {
+    uint64_t fim = f->fim.load(std::memory_order_relaxed);
+    if (fim - f->inicioVisto == N) {
+        f->inicioVisto = f->inicio.load(std::memory_order_acquire);
+        if (fim - f->inicioVisto == N) return 0;
+    }
+    f->elementos[posicaoSPSC<N>(fim)].store(x, std::memory_order_relaxed);
+    f->fim.store(fim + 1, std::memory_order_release);
+    return 1;
+}
+
+// Consumidor: desenfileira a frente em out; retorna 1 em sucesso, 0 se vazia.
+// O início avança com compare-and-swap porque, na versão com sobrescrita,
+// o produtor também pode avançá-lo. Se isso acontecer enquanto a peça é
+// lida, o valor lido pode já ser o novo, mas o CAS falha e ele é descartado.
+// Quando o CAS vence, é o do produtor que falha, e sua leitura (acquire)
+// do início garante que a regravação da posição acontece depois desta.
+template <typename T, int N>
+int desenfileirar(FilaSPSC<T, N> *f, T *out) {
+    uint64_t ini = f->inicio.load(std::memory_order_acquire);
+    for (;;) {
+        // ">=" porque o produtor pode ter avançado o início além da cópia local
+        if (ini >= f->fimVisto) {
+            f->fimVisto = f->fim.load(std::memory_order_acquire);
+            if (ini >= f->fimVisto) return 0;
+        }
+        *out = f->elementos[posicaoSPSC<N>(ini)].load(std::memory_order_relaxed);
+        if (f->inicio.compare_exchange_weak(ini, ini + 1, std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            return 1;
+        }
+        // ini foi atualizado pelo CAS com o início atual; tenta de novo
+    }
+}
+
+// Produtor: enfileira sempre; se cheia, descarta o elemento mais antigo.
+// Retorna 1 se descartou, 0 caso contrário.
+template <typename T, int N>
+int enfileirar_com_sobrescrita(FilaSPSC<T, N> *f, const T &x) {
+    int descartou = 0;
+    uint64_t fim = f->fim.load(std::memory_order_relaxed);
+    uint64_t ini = f->inicio.load(std::memory_order_acquire);
+    // se o consumidor tirar um elemento antes do CAS, não há mais o que descartar
+    while (fim - ini == N) {
+        if (f->inicio.compare_exchange_weak(ini, ini + 1, std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            descartou = 1;
+            break;
+        }
+    }
+    f->inicioVisto = ini;
+    f->elementos[posicaoSPSC<N>(fim)].store(x, std::memory_order_relaxed);
+    f->fim.store(fim + 1, std::memory_order_release);
+    return descartou;
+}
+
+#endif
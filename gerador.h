@@ -0,0 +1,155 @@
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include <stdint.h>
+
+// -----------------------------------------------------------
+// Gerador de peças com semente explícita (xoshiro256**)
+//
+// Cada jogo possui o seu próprio Gerador, então não há estado global
+// como em rand(). A sequência depende apenas da semente e do modo:
+// a mesma semente produz as mesmas peças em qualquer máquina, seja
+// sorteando uma peça por vez ou preenchendo um bloco inteiro.
+// -----------------------------------------------------------
+
+#define NUM_TIPOS 4
+
+// Tipos possíveis de peças
+static const char TIPOS_PECA[NUM_TIPOS] = {'I', 'O', 'T', 'L'};
+
+// Posição do tipo em TIPOS_PECA (2 bits); tipos desconhecidos viram 0
+static inline int indiceTipo(char nome) {
+    for (int t = 0; t < NUM_TIPOS; t++) {
+        if (TIPOS_PECA[t] == nome) return t;
+    }
+    return 0;
+}
+
+// 1 se nome é um dos tipos de TIPOS_PECA
+static inline int tipoValido(char nome) {
+    for (int t = 0; t < NUM_TIPOS; t++) {
+        if (TIPOS_PECA[t] == nome) return 1;
+    }
+    return 0;
+}
+
+#define GERADOR_UNIFORME 0  // cada peça sorteada de forma independente
+#define GERADOR_SACO     1  // "saco": todos os tipos saem uma vez por rodada
+
+typedef struct {
+    uint64_t s[4];            // estado do xoshiro256**
+    uint64_t bits;            // sorteios de 2 bits ainda não consumidos
+    int bitsRestantes;        // quantos sorteios restam em bits
+    int modo;                 // GERADOR_UNIFORME ou GERADOR_SACO
+    char saco[NUM_TIPOS];     // rodada atual do modo saco
+    int posSaco;              // próxima posição a sair do saco
+} Gerador;
+
+// -----------------------------------------------------------
+// Espalha a semente nos 256 bits de estado (splitmix64)
+// -----------------------------------------------------------
+static inline uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl64(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// -----------------------------------------------------------
+// Próximo número de 64 bits
+// -----------------------------------------------------------
+static inline uint64_t proximo64(Gerador *g) {
+    uint64_t *s = g->s;
+    uint64_t resultado = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+    return resultado;
+}
+
+// -----------------------------------------------------------
+// Inicializa o gerador com a semente e o modo de distribuição
+// -----------------------------------------------------------
+static inline void inicializarGerador(Gerador *g, uint64_t semente, int modo) {
+    for (int i = 0; i < 4; i++) {
+        g->s[i] = splitmix64(&semente);
+    }
+    g->bits = 0;
+    g->bitsRestantes = 0;
+    g->modo = modo;
+    for (int i = 0; i < NUM_TIPOS; i++) {
+        g->saco[i] = TIPOS_PECA[i];  // sempre válido, mesmo antes de embaralhar
+    }
+    g->posSaco = NUM_TIPOS; // força embaralhar na primeira peça
+}
+
+// -----------------------------------------------------------
+// Embaralha uma nova rodada do saco (Fisher-Yates)
+// -----------------------------------------------------------
+static inline void encherSaco(Gerador *g) {
+    for (int i = 0; i < NUM_TIPOS; i++) {
+        g->saco[i] = TIPOS_PECA[i];
+    }
+    for (int i = NUM_TIPOS - 1; i > 0; i--) {
+        // j em [0, i] sem divisão (multiplicação de 32x32 bits)
+        int j = (int)(((proximo64(g) >> 32) * (uint64_t)(i + 1)) >> 32);
+        char tmp = g->saco[i];
+        g->saco[i] = g->saco[j];
+        g->saco[j] = tmp;
+    }
+    g->posSaco = 0;
+}
+
+// -----------------------------------------------------------
+// Sorteia o tipo da próxima peça
+// -----------------------------------------------------------
+static inline char proximoTipo(Gerador *g) {
+    if (g->modo == GERADOR_SACO) {
+        if (g->posSaco == NUM_TIPOS) encherSaco(g);
+        return g->saco[g->posSaco++];
+    }
+    // cada número de 64 bits rende 32 sorteios de 2 bits
+    if (g->bitsRestantes == 0) {
+        g->bits = proximo64(g);
+        g->bitsRestantes = 32;
+    }
+    char tipo = TIPOS_PECA[g->bits & 3];
+    g->bits >>= 2;
+    g->bitsRestantes--;
+    return tipo;
+}
+
+// -----------------------------------------------------------
+// Preenche destino com os tipos das próximas n peças.
+// Produz exatamente a mesma sequência de n chamadas a proximoTipo,
+// mas no modo uniforme consome 32 peças por número sorteado.
+// -----------------------------------------------------------
+static inline void preencherTipos(Gerador *g, char *destino, int n) {
+    int i = 0;
+    if (g->modo == GERADOR_UNIFORME) {
+        // esgota os sorteios já guardados antes de usar blocos inteiros
+        while (i < n && g->bitsRestantes > 0) {
+            destino[i++] = proximoTipo(g);
+        }
+        while (n - i >= 32) {
+            uint64_t w = proximo64(g);
+            for (int k = 0; k < 32; k++) {
+                destino[i + k] = TIPOS_PECA[(w >> (2 * k)) & 3];
+            }
+            i += 32;
+        }
+    }
+    while (i < n) {
+        destino[i++] = proximoTipo(g);
+    }
+}
+
+#endif
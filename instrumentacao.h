@@ -0,0 +1,101 @@
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// -----------------------------------------------------------
+// Contadores por operação, ligados apenas ao compilar com
+// -DTETRIS_INSTRUMENTAR (ex.: make instrumentado). Sem a flag as
+// macros ficam vazias e não há custo algum.
+//
+// Cada operação instrumentada começa com INSTR_MEDIR(op), que conta
+// a chamada e os ciclos gastos até a função retornar (incluindo as
+// operações internas, que também são contadas nas suas linhas), e
+// chama INSTR_REJEITADA() antes de retornar por fila/pilha cheia ou
+// vazia. Os contadores são globais e não são seguros entre threads.
+// -----------------------------------------------------------
+
+#define INSTR_ENFILEIRAR      0
+#define INSTR_DESENFILEIRAR   1
+#define INSTR_PUSH            2
+#define INSTR_POP             3
+#define INSTR_GERAR_PECA      4
+#define INSTR_JOGAR           5
+#define INSTR_RESERVAR        6
+#define INSTR_USAR_RESERVADA  7
+#define INSTR_TROCAR_TOPO     8
+#define INSTR_TROCA_MULTIPLA  9
+#define NUM_INSTR            10
+
+#ifdef TETRIS_INSTRUMENTAR
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t lerCiclos(void) {
+    return __rdtsc();
+}
+#else
+#include "tempo.h"
+// sem contador de ciclos acessível: usa nanossegundos
+static inline uint64_t lerCiclos(void) {
+    return (uint64_t)agoraNs();
+}
+#endif
+
+typedef struct {
+    uint64_t chamadas;
+    uint64_t rejeitadas;
+    uint64_t ciclos;
+} ContadorOperacao;
+
+inline ContadorOperacao contadoresOperacao[NUM_INSTR];
+
+// Mede uma chamada do início do escopo até o retorno
+struct MedidorOperacao {
+    int op;
+    int rejeitada;
+    uint64_t inicio;
+
+    explicit MedidorOperacao(int o) : op(o), rejeitada(0), inicio(lerCiclos()) {}
+    ~MedidorOperacao() {
+        ContadorOperacao *c = &contadoresOperacao[op];
+        c->chamadas++;
+        c->rejeitadas += rejeitada;
+        c->ciclos += lerCiclos() - inicio;
+    }
+};
+
+#define INSTR_MEDIR(op) MedidorOperacao medidorOperacao_(op)
+#define INSTR_REJEITADA() (medidorOperacao_.rejeitada = 1)
+
+// Imprime a tabela de contadores das operações chamadas ao menos uma vez
+static inline void relatorioInstrumentacao(FILE *saida) {
+    static const char *nomes[NUM_INSTR] = {
+        "enfileirar", "desenfileirar", "push", "pop", "gerarPeca",
+        "jogarPeca", "reservarPeca", "usarReservada", "trocarTopo", "trocaMultipla",
+    };
+    fprintf(saida, "\n=== INSTRUMENTAÇÃO ===\n");
+    fprintf(saida, "%-18s %14s %14s %16s %12s\n",
+            "Operação", "Chamadas", "Rejeitadas", "Ciclos", "Ciclos/op");
+    for (int i = 0; i < NUM_INSTR; i++) {
+        const ContadorOperacao *c = &contadoresOperacao[i];
+        if (c->chamadas == 0) continue;
+        fprintf(saida, "%-16s %14llu %14llu %16llu %12.1f\n", nomes[i],
+                (unsigned long long)c->chamadas, (unsigned long long)c->rejeitadas,
+                (unsigned long long)c->ciclos, (double)c->ciclos / c->chamadas);
+    }
+}
+
+#else
+
+#define INSTR_MEDIR(op) ((void)0)
+#define INSTR_REJEITADA() ((void)0)
+
+static inline void relatorioInstrumentacao(FILE *saida) {
+    (void)saida;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef MESTRE_H
+#define MESTRE_H
+
+#include "estruturas.h"
+#include "gerador.h"
+#include "instrumentacao.h"
+#include "snapshot.h"
+
+// -----------------------------------------------------------
+// Regras do nível Mestre, sem entrada nem saída: o programa
+// (TetrisStackMestre.C) exibe as mensagens e os benchmarks
+// (bench/operacoes.C) medem exatamente as mesmas funções.
+// -----------------------------------------------------------
+
+#ifndef TAM_FILA
+#define TAM_FILA 5   // capacidade da fila circular
+#endif
+#ifndef TAM_PILHA
+#define TAM_PILHA 3  // capacidade da pilha de reserva
+#endif
+#ifndef TAM_TROCA_MULTIPLA
+#define TAM_TROCA_MULTIPLA 3  // peças trocadas pela opção 5
+#endif
+
+/* ----------- Fila circular e pilha (vetor) de peças ----------- */
+typedef FilaCircular<Peca, TAM_FILA> Fila;
+typedef PilhaLimitada<Peca, TAM_PILHA> Pilha;
+
+/* Estado completo de um jogo (fila, pilha, gerador e contador de ids) */
+typedef EstadoJogo<TAM_FILA, TAM_PILHA> EstadoMestre;
+
+/* Gera peça com id incremental usando o gerador do jogo */
+static inline Peca gerarPeca(Gerador *g, int *contadorId) {
+    INSTR_MEDIR(INSTR_GERAR_PECA);
+    Peca p;
+    p.nome = proximoTipo(g);
+    p.id = (*contadorId)++;
+    return p;
+}
+
+/* Inicializa fila preenchendo-a com TAM_FILA peças */
+static inline void inicializarFila(Fila *f, Gerador *g, int *contadorId) {
+    esvaziarFila(f);
+    for (int i = 0; i < TAM_FILA; ++i) {
+        enfileirar(f, gerarPeca(g, contadorId));
+    }
+}
+
+/* Inicializa pilha vazia */
+static inline void inicializarPilha(Pilha *p) {
+    esvaziarPilha(p);
+}
+
+/* ----------- Resultado das operações ----------- */
+#define RES_OK           0  // operação aplicada
+#define RES_FILA_VAZIA   1  // fila sem peças
+#define RES_PILHA_CHEIA  2  // pilha sem espaço
+#define RES_PILHA_VAZIA  3  // pilha sem peças
+#define RES_FILA_CURTA   4  // fila sem peças suficientes para a troca múltipla
+#define RES_PILHA_CURTA  5  // pilha sem peças suficientes para a troca múltipla
+#define RES_ERRO_PILHA   6  // peça removida da fila mas não empilhada
+#define RES_SEM_NOVA     7  // peça removida mas a nova não coube na fila
+
+/* As funções abaixo aplicam as regras sem imprimir nada; as opções do menu
+   (opJogar, opReservar, ...) chamam estas e exibem a mensagem adequada. */
+
+/* Jogar: remove a frente (em jogada) e enfileira nova peça (em nova) */
+static inline int jogarPeca(Fila *f, Gerador *g, int *contadorId, Peca *jogada, Peca *nova) {
+    INSTR_MEDIR(INSTR_JOGAR);
+    if (!desenfileirar(f, jogada)) {
+        INSTR_REJEITADA();
+        return RES_FILA_VAZIA;
+    }
+    *nova = gerarPeca(g, contadorId);
+    if (!enfileirar(f, *nova)) return RES_SEM_NOVA;
+    return RES_OK;
+}
+
+/* Reservar: move a frente da fila para o topo da pilha e repõe a fila */
+static inline int reservarPeca(Fila *f, Pilha *p, Gerador *g, int *contadorId, Peca *reservada, Peca *nova) {
+    INSTR_MEDIR(INSTR_RESERVAR);
+    if (pilhaCheia(p)) {
+        INSTR_REJEITADA();
+        return RES_PILHA_CHEIA;
+    }
+    if (!desenfileirar(f, reservada)) {
+        INSTR_REJEITADA();
+        return RES_FILA_VAZIA;
+    }
+    if (!push(p, *reservada)) return RES_ERRO_PILHA;
+    *nova = gerarPeca(g, contadorId);
+    if (!enfileirar(f, *nova)) return RES_SEM_NOVA;
+    return RES_OK;
+}
+
+/* Usar reservada: pop do topo da pilha. NÃO gera nova peça */
+static inline int usarReservada(Pilha *p, Peca *usada) {
+    INSTR_MEDIR(INSTR_USAR_RESERVADA);
+    if (!pop(p, usada)) {
+        INSTR_REJEITADA();
+        return RES_PILHA_VAZIA;
+    }
+    return RES_OK;
+}
+
+/* Troca a frente da fila com o topo da pilha */
+static inline int trocarTopo(Fila *f, Pilha *p) {
+    INSTR_MEDIR(INSTR_TROCAR_TOPO);
+    if (f->quantidade == 0) {
+        INSTR_REJEITADA();
+        return RES_FILA_VAZIA;
+    }
+    if (p->topo == 0) {
+        INSTR_REJEITADA();
+        return RES_PILHA_VAZIA;
+    }
+    int idxFrente = idxFila(f, 0);
+    Peca tmp = f->elementos[idxFrente];
+    f->elementos[idxFrente] = p->elementos[p->topo - 1];
+    p->elementos[p->topo - 1] = tmp;
+    return RES_OK;
+}
+
+/* Troca os TAM_TROCA_MULTIPLA primeiros da fila com as peças do topo da pilha.
+   Com a pilha cheia (3 peças), após o exemplo do enunciado:
+   - fila[0] <- topo, fila[1] <- meio, fila[2] <- base
+   - pilha (base->top) <- q0, q1, q2 (com top sendo q2) */
+static inline int trocaMultipla(Fila *f, Pilha *p) {
+    INSTR_MEDIR(INSTR_TROCA_MULTIPLA);
+    if (f->quantidade < TAM_TROCA_MULTIPLA) {
+        INSTR_REJEITADA();
+        return RES_FILA_CURTA;
+    }
+    if (p->topo < TAM_TROCA_MULTIPLA) {
+        INSTR_REJEITADA();
+        return RES_PILHA_CURTA;
+    }
+    trocarFrenteComPilha<TAM_TROCA_MULTIPLA>(f, p);
+    return RES_OK;
+}
+
+/* Aplica uma operação do menu (1 a 5) sem imprimir; retorna o código de resultado */
+static inline int aplicarOperacao(Fila *f, Pilha *p, Gerador *g, int *contadorId, int opcao) {
+    Peca a, b;
+    switch (opcao) {
+        case 1: return jogarPeca(f, g, contadorId, &a, &b);
+        case 2: return reservarPeca(f, p, g, contadorId, &a, &b);
+        case 3: return usarReservada(p, &a);
+        case 4: return trocarTopo(f, p);
+        default: return trocaMultipla(f, p);
+    }
+}
+
+#endif
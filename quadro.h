@@ -0,0 +1,88 @@
+#ifndef QUADRO_H
+#define QUADRO_H
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------
+// Quadro de saída: buffer de tamanho fixo onde uma tela inteira é
+// montada sem alocação nem printf, e depois enviada com um único
+// write. Os inteiros são formatados à mão (sem locale nem parsing
+// de formato). Se o texto não couber, o excesso é descartado.
+//
+// O quadro escreve direto no descritor 1, sem passar pelo buffer de
+// stdout; despejarQuadro esvazia stdout antes para não inverter a
+// ordem caso o programa também use printf.
+// -----------------------------------------------------------
+
+template <int N>
+struct Quadro {
+    char dados[N];
+    int tam;  // bytes ocupados
+
+    static constexpr int capacidade = N;
+};
+
+template <int N>
+void limparQuadro(Quadro<N> *q) {
+    q->tam = 0;
+}
+
+// Acrescenta n bytes de s
+template <int N>
+void quadroBytes(Quadro<N> *q, const char *s, int n) {
+    if (n > N - q->tam) n = N - q->tam;
+    memcpy(q->dados + q->tam, s, n);
+    q->tam += n;
+}
+
+template <int N>
+void quadroTexto(Quadro<N> *q, const char *s) {
+    quadroBytes(q, s, (int)strlen(s));
+}
+
+template <int N>
+void quadroChar(Quadro<N> *q, char c) {
+    if (q->tam < N) q->dados[q->tam++] = c;
+}
+
+// Acrescenta v em decimal
+template <int N>
+void quadroInt(Quadro<N> *q, long long v) {
+    char tmp[20];
+    int n = 0;
+    // trabalha com o módulo em unsigned para aceitar o menor long long
+    unsigned long long u = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (v < 0) quadroChar(q, '-');
+    while (n > 0) quadroChar(q, tmp[--n]);
+}
+
+// Escreve o quadro inteiro na saída padrão e o esvazia.
+// Retorna 1 em sucesso, 0 em erro de escrita.
+template <int N>
+int despejarQuadro(Quadro<N> *q) {
+    fflush(stdout);
+    const char *s = q->dados;
+    int resta = q->tam;
+    // normalmente uma única chamada; repete só em escrita parcial ou sinal
+    while (resta > 0) {
+        ssize_t escritos = write(STDOUT_FILENO, s, resta);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            q->tam = 0;
+            return 0;
+        }
+        s += escritos;
+        resta -= (int)escritos;
+    }
+    q->tam = 0;
+    return 1;
+}
+
+#endif
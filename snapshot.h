@@ -0,0 +1,416 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "estruturas.h"
+#include "gerador.h"
+
+// -----------------------------------------------------------
+// Snapshot do estado completo de um ou mais jogos.
+//
+// Formato (versão 1, inteiros little-endian):
+//   cabeçalho de 16 bytes: "TSSN", versão (u16), flags (u16),
+//   capacidade da fila (u16), da pilha (u16), número de jogos (u32)
+//   e, para cada jogo, em sequência:
+//     contadorId, quantidade e topo (varint)
+//     peças da fila (frente -> fim) e da pilha (base -> topo)
+//     estado do gerador, se SNAP_COM_GERADOR (47 bytes)
+//
+// Cada peça é compactada num varint de (delta << 2) | tipo, onde o
+// tipo ocupa 2 bits e delta = contadorId - 1 - id. Como as peças
+// em jogo são quase sempre recentes, a maioria ocupa 1 byte em vez
+// dos 8 de Peca.
+// -----------------------------------------------------------
+
+#define SNAP_VERSAO        1
+#define SNAP_TAM_CABECALHO 16
+#define SNAP_COM_GERADOR   1  // flag: o estado do gerador acompanha cada jogo
+#define SNAP_FLAGS_CONHECIDAS SNAP_COM_GERADOR  // outros bits tornam o arquivo inválido
+
+#define SNAP_TAM_GERADOR   (5 * 8 + 2 + NUM_TIPOS + 1)
+
+// -----------------------------------------------------------
+// Estado completo de um jogo
+// -----------------------------------------------------------
+template <int N, int M>
+struct EstadoJogo {
+    FilaCircular<Peca, N> fila;
+    PilhaLimitada<Peca, M> pilha;
+    Gerador gerador;
+    int contadorId;
+};
+
+// -----------------------------------------------------------
+// Inteiros em bytes
+// -----------------------------------------------------------
+static inline uint8_t *escreverVarint(uint8_t *d, uint64_t v) {
+    while (v >= 0x80) {
+        *d++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *d++ = (uint8_t)v;
+    return d;
+}
+
+// Retorna NULL se o varint estiver truncado ou longo demais
+static inline const uint8_t *lerVarint(const uint8_t *s, const uint8_t *fim, uint64_t *v) {
+    uint64_t r = 0;
+    for (int desloc = 0; s < fim && desloc < 64; desloc += 7) {
+        uint8_t b = *s++;
+        r |= (uint64_t)(b & 0x7F) << desloc;
+        if (!(b & 0x80)) {
+            *v = r;
+            return s;
+        }
+    }
+    return NULL;
+}
+
+static inline uint8_t *escreverU64(uint8_t *d, uint64_t v) {
+    for (int i = 0; i < 8; i++) *d++ = (uint8_t)(v >> (8 * i));
+    return d;
+}
+
+static inline uint64_t lerU64(const uint8_t *s) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)s[i] << (8 * i);
+    return v;
+}
+
+static inline void escreverU16(uint8_t *d, unsigned v) {
+    d[0] = (uint8_t)v;
+    d[1] = (uint8_t)(v >> 8);
+}
+
+static inline unsigned lerU16(const uint8_t *s) {
+    return s[0] | (unsigned)s[1] << 8;
+}
+
+// -----------------------------------------------------------
+// Peça compactada: tipo em 2 bits (indiceTipo) + id relativo ao contadorId
+// -----------------------------------------------------------
+static inline uint8_t *escreverPeca(uint8_t *d, Peca p, int contadorId) {
+    uint64_t delta = (uint64_t)(uint32_t)(contadorId - 1 - p.id);
+    return escreverVarint(d, delta << 2 | (uint64_t)indiceTipo(p.nome));
+}
+
+// Retorna NULL se o varint estiver corrompido ou se o id ficar fora de
+// [0, contadorId): toda peça em jogo foi gerada antes do contador atual
+static inline const uint8_t *lerPeca(const uint8_t *s, const uint8_t *fim, Peca *p, int contadorId) {
+    uint64_t v;
+    s = lerVarint(s, fim, &v);
+    if (s == NULL || (v >> 2) >= (uint64_t)contadorId) return NULL;
+    p->nome = TIPOS_PECA[v & 3];
+    p->id = contadorId - 1 - (int)(v >> 2);
+    return s;
+}
+
+// -----------------------------------------------------------
+// Um jogo
+// -----------------------------------------------------------
+
+// Limite superior de bytes de um jogo codificado
+template <int N, int M>
+size_t tamanhoMaximoJogo(int flags) {
+    size_t t = 3 * 10 + (size_t)(N + M) * 10;
+    if (flags & SNAP_COM_GERADOR) t += SNAP_TAM_GERADOR;
+    return t;
+}
+
+// Codifica o jogo em d; retorna o ponteiro após o último byte escrito
+template <int N, int M>
+uint8_t *codificarJogo(uint8_t *d, const EstadoJogo<N, M> *e, int flags) {
+    const FilaCircular<Peca, N> *f = &e->fila;
+    const PilhaLimitada<Peca, M> *p = &e->pilha;
+
+    d = escreverVarint(d, (uint32_t)e->contadorId);
+    d = escreverVarint(d, (uint64_t)f->quantidade);
+    d = escreverVarint(d, (uint64_t)p->topo);
+    for (int i = 0; i < f->quantidade; i++) {
+        d = escreverPeca(d, f->elementos[idxFila(f, i)], e->contadorId);
+    }
+    for (int i = 0; i < p->topo; i++) {
+        d = escreverPeca(d, p->elementos[i], e->contadorId);
+    }
+
+    if (flags & SNAP_COM_GERADOR) {
+        const Gerador *g = &e->gerador;
+        for (int i = 0; i < 4; i++) d = escreverU64(d, g->s[i]);
+        d = escreverU64(d, g->bits);
+        *d++ = (uint8_t)g->bitsRestantes;
+        *d++ = (uint8_t)g->modo;
+        for (int i = 0; i < NUM_TIPOS; i++) *d++ = (uint8_t)g->saco[i];
+        *d++ = (uint8_t)g->posSaco;
+    }
+    return d;
+}
+
+// Decodifica um jogo de [s, fim); retorna o ponteiro após o jogo ou NULL
+// se os dados estiverem corrompidos ou não couberem nas capacidades N/M.
+// O gerador restaurado só é aceito com modo conhecido e saco formado por
+// tipos de TIPOS_PECA. Sem SNAP_COM_GERADOR o gerador de e não é alterado.
+template <int N, int M>
+const uint8_t *decodificarJogo(const uint8_t *s, const uint8_t *fim, EstadoJogo<N, M> *e, int flags) {
+    uint64_t contador, qtd, topo;
+    if ((s = lerVarint(s, fim, &contador)) == NULL) return NULL;
+    if ((s = lerVarint(s, fim, &qtd)) == NULL) return NULL;
+    if ((s = lerVarint(s, fim, &topo)) == NULL) return NULL;
+    if (contador > INT32_MAX || qtd > (uint64_t)N || topo > (uint64_t)M) return NULL;
+
+    e->contadorId = (int)contador;
+    esvaziarFila(&e->fila);
+    esvaziarPilha(&e->pilha);
+    for (uint64_t i = 0; i < qtd; i++) {
+        Peca pc;
+        if ((s = lerPeca(s, fim, &pc, e->contadorId)) == NULL) return NULL;
+        enfileirar(&e->fila, pc);
+    }
+    for (uint64_t i = 0; i < topo; i++) {
+        Peca pc;
+        if ((s = lerPeca(s, fim, &pc, e->contadorId)) == NULL) return NULL;
+        push(&e->pilha, pc);
+    }
+
+    if (flags & SNAP_COM_GERADOR) {
+        if (fim - s < SNAP_TAM_GERADOR) return NULL;
+        Gerador *g = &e->gerador;
+        for (int i = 0; i < 4; i++, s += 8) g->s[i] = lerU64(s);
+        g->bits = lerU64(s);
+        s += 8;
+        g->bitsRestantes = *s++;
+        g->modo = *s++;
+        for (int i = 0; i < NUM_TIPOS; i++) g->saco[i] = (char)*s++;
+        g->posSaco = *s++;
+        if (g->bitsRestantes > 32 || g->posSaco > NUM_TIPOS) return NULL;
+        if (g->modo != GERADOR_UNIFORME && g->modo != GERADOR_SACO) return NULL;
+        for (int i = 0; i < NUM_TIPOS; i++) {
+            if (!tipoValido(g->saco[i])) return NULL;
+        }
+    }
+    return s;
+}
+
+// -----------------------------------------------------------
+// Cabeçalho
+// -----------------------------------------------------------
+template <int N, int M>
+void escreverCabecalho(uint8_t *d, int numJogos, int flags) {
+    memcpy(d, "TSSN", 4);
+    escreverU16(d + 4, SNAP_VERSAO);
+    escreverU16(d + 6, (unsigned)flags);
+    escreverU16(d + 8, N);
+    escreverU16(d + 10, M);
+    for (int i = 0; i < 4; i++) d[12 + i] = (uint8_t)((uint32_t)numJogos >> (8 * i));
+}
+
+// Valida o cabeçalho; retorna o número de jogos ou -1. Em *flags, *capFila
+// e *capPilha ficam as flags e as capacidades com que o arquivo foi gravado.
+static inline int lerCabecalho(const uint8_t *s, size_t tamanho, int *flags,
+                               int *capFila, int *capPilha) {
+    if (tamanho < SNAP_TAM_CABECALHO || memcmp(s, "TSSN", 4) != 0) return -1;
+    if (lerU16(s + 4) != SNAP_VERSAO) return -1;
+    *flags = (int)lerU16(s + 6);
+    if (*flags & ~SNAP_FLAGS_CONHECIDAS) return -1;
+    *capFila = (int)lerU16(s + 8);
+    *capPilha = (int)lerU16(s + 10);
+    uint32_t n = s[12] | (uint32_t)s[13] << 8 | (uint32_t)s[14] << 16 | (uint32_t)s[15] << 24;
+    // cada jogo ocupa ao menos 3 bytes (contadorId, quantidade e topo):
+    // um número maior que isso não cabe no arquivo e é rejeitado antes
+    // que alguém aloque espaço para ele
+    if (n > (tamanho - SNAP_TAM_CABECALHO) / 3) return -1;
+    return (int)n;
+}
+
+// -----------------------------------------------------------
+// Lote compacto: jogos mantidos em memória já codificados, no mesmo
+// formato do arquivo (cabeçalho incluso). Um jogo de 5/3 peças ocupa
+// cerca de 11 bytes em vez dos 88 de EstadoJogo sem o gerador, ou 58
+// em vez de 144 com ele (o estado do xoshiro não se comprime). Serve
+// para guardar muitos estados sem manter a forma expandida, que só é
+// materializada um jogo por vez com lerJogoDoLote.
+// -----------------------------------------------------------
+typedef struct {
+    uint8_t *dados;      // cabeçalho + jogos codificados
+    size_t tamanho;      // bytes ocupados
+    size_t capacidade;   // bytes alocados
+    int numJogos;
+    int flags;
+} LoteCompacto;
+
+// Prepara um lote vazio com espaço para jogosPrevistos jogos;
+// retorna 1 em sucesso, 0 sem memória
+template <int N, int M>
+int iniciarLote(LoteCompacto *l, int flags, int jogosPrevistos) {
+    l->capacidade = SNAP_TAM_CABECALHO + (size_t)jogosPrevistos * tamanhoMaximoJogo<N, M>(flags);
+    l->dados = (uint8_t *)malloc(l->capacidade);
+    if (l->dados == NULL) return 0;
+    l->tamanho = SNAP_TAM_CABECALHO;
+    l->numJogos = 0;
+    l->flags = flags;
+    escreverCabecalho<N, M>(l->dados, 0, flags);
+    return 1;
+}
+
+// Codifica e acrescenta um jogo, dobrando o buffer quando necessário;
+// retorna 1 em sucesso, 0 sem memória (o lote continua válido)
+template <int N, int M>
+int adicionarJogo(LoteCompacto *l, const EstadoJogo<N, M> *e) {
+    size_t max = tamanhoMaximoJogo<N, M>(l->flags);
+    if (l->capacidade - l->tamanho < max) {
+        size_t cap = l->capacidade * 2;
+        if (cap < l->tamanho + max) cap = l->tamanho + max;
+        uint8_t *d = (uint8_t *)realloc(l->dados, cap);
+        if (d == NULL) return 0;
+        l->dados = d;
+        l->capacidade = cap;
+    }
+    l->tamanho = (size_t)(codificarJogo(l->dados + l->tamanho, e, l->flags) - l->dados);
+    l->numJogos++;
+    escreverCabecalho<N, M>(l->dados, l->numJogos, l->flags);
+    return 1;
+}
+
+// Decodifica o jogo em *pos (um deslocamento em dados, começando em
+// SNAP_TAM_CABECALHO) e avança *pos; retorna 1 se leu, 0 no fim ou em erro
+template <int N, int M>
+int lerJogoDoLote(const LoteCompacto *l, size_t *pos, EstadoJogo<N, M> *e) {
+    if (*pos >= l->tamanho) return 0;
+    const uint8_t *s = decodificarJogo(l->dados + *pos, l->dados + l->tamanho, e, l->flags);
+    if (s == NULL) return 0;
+    *pos = (size_t)(s - l->dados);
+    return 1;
+}
+
+// Grava o lote como um snapshot com uma única escrita; retorna 1 em sucesso
+static inline int salvarLote(const char *caminho, const LoteCompacto *l) {
+    FILE *arq = fopen(caminho, "wb");
+    int ok = arq != NULL && fwrite(l->dados, 1, l->tamanho, arq) == l->tamanho;
+    if (arq != NULL && fclose(arq) != 0) ok = 0;
+    return ok;
+}
+
+static inline void liberarLote(LoteCompacto *l) {
+    free(l->dados);
+    l->dados = NULL;
+    l->tamanho = l->capacidade = 0;
+    l->numJogos = 0;
+}
+
+// -----------------------------------------------------------
+// Arquivo inteiro: a codificação é feita em memória e gravada
+// com uma única escrita; a leitura carrega o arquivo de uma vez.
+// -----------------------------------------------------------
+
+// Salva n jogos; retorna 1 em sucesso, 0 em erro
+template <int N, int M>
+int salvarSnapshot(const char *caminho, const EstadoJogo<N, M> *jogos, int n, int flags) {
+    LoteCompacto lote;
+    if (!iniciarLote<N, M>(&lote, flags, n)) return 0;
+    for (int i = 0; i < n; i++) {
+        adicionarJogo(&lote, &jogos[i]);  // não realoca: o espaço já foi reservado
+    }
+    int ok = salvarLote(caminho, &lote);
+    liberarLote(&lote);
+    return ok;
+}
+
+// Carrega até max jogos; retorna quantos foram lidos ou -1 em erro.
+// Em *flags informa se o gerador foi restaurado (SNAP_COM_GERADOR).
+template <int N, int M>
+int carregarSnapshot(const char *caminho, EstadoJogo<N, M> *jogos, int max, int *flags) {
+    FILE *arq = fopen(caminho, "rb");
+    if (arq == NULL) return -1;
+    fseek(arq, 0, SEEK_END);
+    long tamanho = ftell(arq);
+    fseek(arq, 0, SEEK_SET);
+    uint8_t *buf = tamanho > 0 ? (uint8_t *)malloc((size_t)tamanho) : NULL;
+    int lidos = -1;
+
+    if (buf != NULL && fread(buf, 1, (size_t)tamanho, arq) == (size_t)tamanho) {
+        int capFila = 0, capPilha = 0;
+        int n = lerCabecalho(buf, (size_t)tamanho, flags, &capFila, &capPilha);
+        // jogos gravados com outras capacidades não são o mesmo jogo
+        if (capFila != N || capPilha != M) n = -1;
+        const uint8_t *s = buf + SNAP_TAM_CABECALHO;
+        const uint8_t *fim = buf + tamanho;
+        lidos = 0;
+        while (n >= 0 && lidos < n && lidos < max && s != NULL) {
+            s = decodificarJogo(s, fim, &jogos[lidos], *flags);
+            if (s != NULL) lidos++;
+        }
+        if (n < 0 || s == NULL) lidos = -1;
+    }
+    free(buf);
+    fclose(arq);
+    return lidos;
+}
+
+// -----------------------------------------------------------
+// Leitura mapeada em memória, para arquivos grandes: os jogos são
+// decodificados em sequência diretamente do mapeamento, sem copiar
+// o arquivo para um buffer.
+// -----------------------------------------------------------
+typedef struct {
+    const uint8_t *dados;   // início do mapeamento
+    size_t tamanho;         // bytes mapeados
+    const uint8_t *cursor;  // próximo jogo a decodificar
+    int numJogos;           // jogos declarados no cabeçalho
+    int lidos;              // jogos já decodificados
+    int flags;
+    int capFila, capPilha;  // capacidades com que os jogos foram gravados
+} SnapshotMapeado;
+
+// Mapeia o arquivo; retorna 1 em sucesso, 0 em erro
+static inline int mapearSnapshot(const char *caminho, SnapshotMapeado *m) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < SNAP_TAM_CABECALHO) {
+        close(fd);
+        return 0;
+    }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return 0;
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    m->dados = (const uint8_t *)p;
+    m->tamanho = (size_t)st.st_size;
+    m->numJogos = lerCabecalho(m->dados, m->tamanho, &m->flags, &m->capFila, &m->capPilha);
+    m->cursor = m->dados + SNAP_TAM_CABECALHO;
+    m->lidos = 0;
+    if (m->numJogos < 0) {
+        munmap(p, m->tamanho);
+        return 0;
+    }
+    return 1;
+}
+
+// Decodifica o próximo jogo; retorna 1 se leu, 0 no fim ou em erro
+// (inclusive se o arquivo foi gravado com capacidades diferentes de N/M)
+template <int N, int M>
+int lerProximoJogo(SnapshotMapeado *m, EstadoJogo<N, M> *e) {
+    if (m->cursor == NULL || m->lidos == m->numJogos) return 0;
+    if (m->capFila != N || m->capPilha != M) return 0;
+    m->cursor = decodificarJogo(m->cursor, m->dados + m->tamanho, e, m->flags);
+    if (m->cursor == NULL) return 0;
+    m->lidos++;
+    return 1;
+}
+
+static inline void desmapearSnapshot(SnapshotMapeado *m) {
+    munmap((void *)m->dados, m->tamanho);
+    m->dados = NULL;
+    m->cursor = NULL;
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef TEMPO_H
+#define TEMPO_H
+
+#include <time.h>
+
+// -----------------------------------------------------------
+// Relógio monotônico usado para medir tempos de execução
+// -----------------------------------------------------------
+
+static inline long long agoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline double agoraSegundos(void) {
+    return agoraNs() / 1e9;
+}
+
+#endif